@@ -117,6 +117,21 @@ def test_serial():
     assert log_end.split()[-1] == "End"
 
 
+def test_frozen_flow():
+    """Test that axialFlowTurbineALSource writes its performance when
+    advanced in frozen flow with `actuatorFrozenFlow`.
+    """
+    output_clean = subprocess.check_output("./Allclean")
+    output_run = subprocess.check_output("./Allrun")
+    subprocess.check_output("rm -rf postProcessing", shell=True)
+    out = subprocess.check_output(["actuatorFrozenFlow", "-steps", "3"])
+    print(out.decode())
+    check_al_file_exists()
+    df = pd.read_csv("postProcessing/turbines/0/turbine.csv")
+    assert len(df) == 3
+    assert df.time.is_unique
+
+
 def test_parallel():
     """Test axialFlowTurbineALSource in parallel."""
     output_clean = subprocess.check_output("./Allclean")
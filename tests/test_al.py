@@ -119,6 +119,36 @@ def test_3d():
     assert log_end.split()[-1] == "End"
 
 
+def test_end_effects():
+    """Test the lifting line end effect factors of a 3-D actuator line
+    against a direct solve of the lifting line equations.
+    """
+    get_tutorial_files(case="static")
+    subprocess.check_output(["sed", "-i", "s/endEffects .*off;/endEffects"
+                             "          on;/", "system/fvOptions.template"])
+    out = subprocess.check_output("./Allclean")
+    out = subprocess.check_output(["./Allrun", "3D", str(alpha_deg)])
+    n_elements = 12 # Not detected automatically
+    chord = 0.1 # Not detected automatically
+    length = 1.0 # Not detected automatically
+    root_dist = np.zeros(n_elements)
+    factors = np.zeros(n_elements)
+    for i in range(n_elements):
+        fpath = os.path.join(element_dir, "foil.element{}.csv".format(i))
+        df = pd.read_csv(fpath)
+        root_dist[i] = df.root_dist.iloc[-1]
+        factors[i] = df.end_effect_factor.iloc[-1]
+    # Solve for the Fourier coefficients of the circulation
+    theta = root_dist*np.pi
+    n = np.arange(1, n_elements + 1)
+    sin_n_theta = np.sin(np.outer(theta, n))
+    lhs = 2*length/(np.pi*chord)*sin_n_theta \
+        + n*sin_n_theta/np.sin(theta)[:, None]
+    a = np.linalg.solve(lhs, 0.1*np.ones(n_elements))
+    cl = 2*length*sin_n_theta.dot(a)/(0.5*chord)
+    np.testing.assert_allclose(factors, cl/cl.max(), atol=1e-5)
+
+
 @timed(30) # Test must run faster than 30 seconds
 def test_parallel():
     """Test 3-D actuatorLineSource in parallel."""
@@ -136,6 +166,38 @@ def test_parallel():
     assert "Finalising parallel run" in log_end
 
 
+def test_inflow_replay():
+    """Test that the per-element replay of a recorded inflow reproduces the
+    forces of the batched actuator line evaluation.
+    """
+    get_tutorial_files(case="static")
+    subprocess.check_output(["sed", "-i", "/endEffects/a\\        "
+                             "inflowRecord {{ active on; }}",
+                             "system/fvOptions.template"])
+    out = subprocess.check_output("./Allclean")
+    out = subprocess.check_output(["./Allrun", "2D", str(alpha_deg)])
+    record = "postProcessing/actuatorLines/0/foil.inflow.perf"
+    assert os.path.isfile(record)
+    out = subprocess.check_output(["actuatorInflowReplay", record]).decode()
+    print(out)
+    txt = [l for l in out.split("\n") if l.startswith("Maximum change")][0]
+    max_change = [float(v) for v in
+                  txt.split(":")[-1].strip().strip("()").split()]
+    np.testing.assert_allclose(max_change, 0.0, atol=1e-10)
+    replay_dir = "postProcessing/actuatorInflowReplay/0/"
+    element_files = [f for f in os.listdir(element_dir)
+                     if f.startswith("foil.element")]
+    assert element_files
+    for f in element_files:
+        df = pd.read_csv(os.path.join(element_dir, f))
+        df_replay = pd.read_csv(os.path.join(replay_dir, f))
+        df = df.merge(df_replay, on="time", suffixes=("", "_replay"))
+        assert len(df) > 0
+        for q in ["cl", "cd", "fx", "fy", "fz"]:
+            np.testing.assert_allclose(df[q], df[q + "_replay"], rtol=1e-5,
+                                       atol=1e-8)
+
+
 def check_pitching_geom():
     """Check that the geometric values of the pitch match those prescribed."""
     # Read the pitching parameters from fvOptions
@@ -166,6 +228,52 @@ def test_pitching():
     check_pitching_geom()
 
 
+def test_load_update():
+    """Test that the loads are written once per time step with several
+    outer correctors, for both load update policies.
+    """
+    for policy in ["everyOuterCorrector", "oncePerStep"]:
+        get_tutorial_files(case="pitching")
+        subprocess.check_output(["sed", "-i", "/nOuterCorrectors/c\\    "
+                                 "nOuterCorrectors    3;",
+                                 "system/fvSolution"])
+        subprocess.check_output(["sed", "-i", "/writePerf /a\\        "
+                                 "loadUpdate          {};".format(policy),
+                                 "system/fvOptions"])
+        out = subprocess.check_output("./Allclean")
+        out = subprocess.check_output("./Allrun")
+        df = load_output()
+        print(policy, df.time.values)
+        assert len(df) == 4
+        assert df.time.is_unique
+
+
+def test_restart():
+    """Test that a restarted pitching case continues the actuator line
+    loads of the uninterrupted run.
+    """
+    get_tutorial_files(case="pitching")
+    out = subprocess.check_output("./Allclean")
+    out = subprocess.check_output("./Allrun")
+    df = pd.read_csv(output_fpath)
+    # Restart from the first write time after removing the later ones
+    restart_time = 0.05
+    subprocess.check_output("rm -rf 0.1", shell=True)
+    subprocess.check_output(["sed", "-i",
+                             "/startFrom /c\\startFrom       latestTime;",
+                             "system/controlDict"])
+    out = subprocess.check_output("pimpleFoam > log.pimpleFoam.restart",
+                                  shell=True)
+    assert os.path.isfile("0.05/uniform/actuatorState.foil")
+    df_restart = pd.read_csv("postProcessing/actuatorLines/0.05/foil.csv")
+    df = df[df.time > restart_time + 1e-9].reset_index(drop=True)
+    assert len(df) > 0
+    assert len(df_restart) == len(df)
+    for q in df.columns:
+        np.testing.assert_allclose(df_restart[q], df[q], rtol=1e-4,
+                                   atol=1e-5)
+
+
 def teardown():
     """Move back into tests directory."""
     os.chdir("../")
@@ -0,0 +1,110 @@
+#!/usr/bin/env python
+"""Tests for the sectional models with `actuatorModelBenchmark`."""
+
+from __future__ import division, print_function
+import subprocess
+import pandas as pd
+import os
+import numpy as np
+
+
+def setup():
+    os.chdir("actuatorModelBenchmark")
+
+
+def run_benchmark(*args):
+    """Run `actuatorModelBenchmark` and return its output."""
+    cmd = ["actuatorModelBenchmark", "-outputDir", "output"] + list(args)
+    try:
+        return subprocess.check_output(cmd,
+                                       stderr=subprocess.STDOUT).decode()
+    except subprocess.CalledProcessError as e:
+        print(e.output.decode())
+        raise
+
+
+def test_reference():
+    """Test that the scalar and batch models reproduce the references."""
+    out = run_benchmark("-reference", "reference")
+    print(out)
+    assert '"pass": false' not in out
+    assert '"pass": true' in out
+
+
+def test_batch_dynamic_stall():
+    """Test that the batch dynamic stall models match the scalar ones on the
+    pitching history.
+    """
+    run_benchmark()
+    for model in ["LeishmanBeddoes", "LeishmanBeddoes3G", "LeishmanBeddoesSGC",
+                  "LeishmanBeddoesSD"]:
+        fpath = "output/sinusoidal.NACA0012.{}.csv"
+        df = pd.read_csv(fpath.format(model))
+        df_batch = pd.read_csv(fpath.format(model + ".batch"))
+        assert len(df) == len(df_batch)
+        np.testing.assert_allclose(df_batch.time, df.time)
+        for q in ["cl", "cd", "cm"]:
+            np.testing.assert_allclose(df_batch[q], df[q], rtol=1e-8,
+                                       atol=1e-10)
+
+
+def load_spline_table(profile="linear"):
+    """Load the nodes of a profile table from `splineTableDict`."""
+    with open("splineTableDict") as f:
+        txt = f.read()
+    txt = txt[txt.index("    " + profile + "\n"):]
+    txt = txt[txt.index("( // alpha"):txt.index(");")]
+    rows = [l.strip().strip("()").split() for l in txt.split("\n")[1:]]
+    return np.array([[float(v) for v in r] for r in rows if r])
+
+
+def test_spline_table():
+    """Test the interpolation schemes of the profile coefficient tables."""
+    run_benchmark("-dict", "splineTableDict")
+    table = load_spline_table()
+    alpha_nodes, nodes = table[:, 0], table[:, 1:]
+    for scheme in ["linear", "monotoneCubic", "Akima"]:
+        df = pd.read_csv("output/ramp.{}.static.csv".format(scheme))
+        coeffs = df[["cl", "cd"]].values
+        # All schemes pass through the nodes
+        at_node = np.isclose(df.alpha_deg.values[:, None], alpha_nodes,
+                             atol=1e-9)
+        i, j = np.nonzero(at_node)
+        assert len(i) == len(alpha_nodes) - 1
+        np.testing.assert_allclose(coeffs[i], nodes[j], atol=1e-9)
+        if scheme == "linear":
+            for k in range(nodes.shape[1]):
+                np.testing.assert_allclose(coeffs[:, k],
+                                           np.interp(df.alpha_deg,
+                                                     alpha_nodes,
+                                                     nodes[:, k]),
+                                           atol=1e-9)
+        elif scheme == "monotoneCubic":
+            # Values stay within those of the bracketing nodes
+            seg = np.clip(np.searchsorted(alpha_nodes, df.alpha_deg) - 1,
+                          0, len(alpha_nodes) - 2)
+            lower = np.minimum(nodes[seg], nodes[seg + 1])
+            upper = np.maximum(nodes[seg], nodes[seg + 1])
+            assert np.all(coeffs >= lower - 1e-9)
+            assert np.all(coeffs <= upper + 1e-9)
+
+
+def test_spline_table_invalid():
+    """Test that a table with non-increasing angles of attack is rejected."""
+    with open("splineTableDict") as f:
+        txt = f.read()
+    with open("splineTableDict.invalid", "w") as f:
+        f.write(txt.replace("(4 0.4 0.02)", "(-4 0.4 0.02)", 1))
+    cmd = ["actuatorModelBenchmark", "-dict", "splineTableDict.invalid",
+           "-outputDir", "output"]
+    p = subprocess.Popen(cmd, stdout=subprocess.PIPE,
+                         stderr=subprocess.STDOUT)
+    out = p.communicate()[0].decode()
+    print(out)
+    assert p.returncode != 0
+    assert "Abscissae of table linear are not strictly increasing" in out
+
+
+def teardown():
+    """Move back into tests directory."""
+    os.chdir("../")
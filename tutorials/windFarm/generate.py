@@ -0,0 +1,455 @@
+#!/usr/bin/env python
+"""
+This script generates the `blockMeshDict`, `topoSetDict`, `decomposeParDict`,
+`fvOptions` and `controlDict` of a wind farm benchmark case, i.e., a grid of
+axial- and/or cross-flow turbine actuator line sources in a uniform mesh.
+"""
+
+from __future__ import division, print_function, absolute_import
+import argparse
+import os
+
+
+header = r"""/*--------------------------------*- C++ -*----------------------------------*\
+| =========                 |                                                 |
+| \\      /  F ield         | OpenFOAM: The Open Source CFD Toolbox           |
+|  \\    /   O peration     | Version:  3.0.x                                 |
+|   \\  /    A nd           | Web:      www.OpenFOAM.org                      |
+|    \\/     M anipulation  |                                                 |
+\*---------------------------------------------------------------------------*/
+FoamFile
+{{
+    version     2.0;
+    format      ascii;
+    class       dictionary;
+    location    "system";
+    object      {};
+}}
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+"""
+
+footer = """
+// ************************************************************************* //
+"""
+
+foil_data_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                             os.pardir, "resources", "foilData")
+
+# Rotor diameters of the turbines from the axial- and cross-flow tutorials
+diameters = {"axial": 0.9, "cross": 1.0}
+
+# Axial-flow turbine blade geometry, a coarser version of the tutorial's
+# axialDistance, radius, azimuth, chord, chordMount, pitch
+axial_blade_data = [(0.0, 0.054999, 0.0, 0.0495, 0.25, 38.0),
+                    (0.0, 0.0975015, 0.0, 0.077013, 0.25, 28.677),
+                    (0.0, 0.1575, 0.0, 0.061101, 0.25, 18.034),
+                    (0.0, 0.2175, 0.0, 0.048447, 0.25, 11.829),
+                    (0.0, 0.2775015, 0.0, 0.0396009, 0.25, 7.9877),
+                    (0.0, 0.3375, 0.0, 0.0333063, 0.25, 5.3045),
+                    (0.0, 0.3974985, 0.0, 0.02866365, 0.25, 2.9433),
+                    (0.0, 0.4424985, 0.0, 0.02592585, 0.25, -0.71674)]
+
+
+def turbine_types(args):
+    """Return the type of each turbine in the grid, row by row."""
+    types = []
+    for i in range(args.rows):
+        for j in range(args.cols):
+            if args.type == "mixed":
+                types.append(["axial", "cross"][(i + j) % 2])
+            else:
+                types.append(args.type)
+    return types
+
+
+def spacing(args):
+    """Return the streamwise and lateral spacing of turbines in meters."""
+    d = max(diameters[t] for t in set(turbine_types(args)))
+    return args.spacing_x*d, args.spacing_y*d, d
+
+
+def turbine_origins(args):
+    """Return the origin of each turbine in the grid, row by row."""
+    dx, dy, d = spacing(args)
+    y0 = -0.5*(args.cols - 1)*dy
+    return [(i*dx, y0 + j*dy, 0.0) for i in range(args.rows)
+            for j in range(args.cols)]
+
+
+def domain(args):
+    """Return the minimum and maximum corners of the domain."""
+    dx, dy, d = spacing(args)
+    xmin = -args.upstream*d
+    xmax = (args.rows - 1)*dx + args.downstream*d
+    ymax = 0.5*(args.cols - 1)*dy + args.margin*d
+    zmax = args.margin*d
+    return (xmin, -ymax, -zmax), (xmax, ymax, zmax)
+
+
+def n_cells(args):
+    """Return the number of cells in each direction."""
+    (x0, y0, z0), (x1, y1, z1) = domain(args)
+    dx, dy, d = spacing(args)
+    h = d/args.cells_per_diameter
+    return tuple(max(int(round(l/h)), 1) for l in (x1 - x0, y1 - y0, z1 - z0))
+
+
+def decomposition(n):
+    """Split `n` processors as evenly as possible over x and y."""
+    nx = 1
+    for f in range(1, int(n**0.5) + 1):
+        if n % f == 0:
+            nx = f
+    return n//nx, nx, 1
+
+
+def block_mesh_dict(args):
+    (x0, y0, z0), (x1, y1, z1) = domain(args)
+    vertices = [(x0, y0, z0), (x1, y0, z0), (x1, y1, z0), (x0, y1, z0),
+                (x0, y0, z1), (x1, y0, z1), (x1, y1, z1), (x0, y1, z1)]
+    txt = header.format("blockMeshDict")
+    txt += "convertToMeters 1;\n\nvertices\n(\n"
+    for n, v in enumerate(vertices):
+        txt += "    ({:g} {:g} {:g}) // {}\n".format(*(v + (n,)))
+    txt += ");\n\nblocks\n(\n    hex (0 1 2 3 4 5 6 7)\n"
+    txt += "    ({} {} {})\n".format(*n_cells(args))
+    txt += "    simpleGrading (1 1 1)\n);\n\nboundary\n(\n"
+    patches = [("inlet", "patch", ["(0 4 7 3)"]),
+               ("outlet", "patch", ["(1 2 6 5)"]),
+               ("sides", "patch", ["(0 1 5 4)", "(3 7 6 2)", "(0 3 2 1)",
+                                   "(4 5 6 7)"])]
+    for name, ptype, faces in patches:
+        txt += "    {}\n    {{\n        type {};\n".format(name, ptype)
+        txt += "        faces\n        (\n"
+        for f in faces:
+            txt += "            {}\n".format(f)
+        txt += "        );\n    }\n\n"
+    txt = txt.rstrip("\n") + "\n);\n\nedges\n(\n);\n\n"
+    txt += "mergePatchPairs\n(\n);\n"
+    return txt + footer
+
+
+def topo_set_dict(args):
+    txt = header.format("topoSetDict") + "actions\n(\n"
+    for n, (t, o) in enumerate(zip(turbine_types(args),
+                                   turbine_origins(args))):
+        name = "turbine{}".format(n + 1)
+        r = 0.5*diameters[t]
+        if t == "axial":
+            p1 = (o[0] - 0.25, o[1], o[2])
+            p2 = (o[0] + 0.25, o[1], o[2])
+            radius = 1.33*r
+        else:
+            p1 = (o[0], o[1], o[2] - 0.8)
+            p2 = (o[0], o[1], o[2] + 0.8)
+            radius = 1.2*r
+        txt += "    {\n"
+        txt += "        name    {};\n".format(name)
+        txt += "        type    cellSet;\n        action  new;\n"
+        txt += "        source  cylinderToCell;\n        sourceInfo\n"
+        txt += "        {\n            type cylinder;\n"
+        txt += "            p1 ({:g} {:g} {:g});\n".format(*p1)
+        txt += "            p2 ({:g} {:g} {:g});\n".format(*p2)
+        txt += "            radius {:g};\n".format(radius)
+        txt += "        }\n    }\n\n"
+        txt += "    {\n"
+        txt += "        name    {};\n".format(name)
+        txt += "        type    cellZoneSet;\n        action  new;\n"
+        txt += "        source  setToCellZone;\n        sourceInfo\n"
+        txt += "        {{\n            set {};\n        }}\n".format(name)
+        txt += "    }\n\n"
+    txt = txt.rstrip("\n") + "\n);\n"
+    return txt + footer
+
+
+def decompose_par_dict(args):
+    txt = header.format("decomposeParDict")
+    txt += "numberOfSubdomains {};\n\n".format(args.n_procs)
+    txt += "method          {};\n\n".format(args.method)
+    txt += "hierarchicalCoeffs\n{\n"
+    txt += "    n               ({} {} {});\n".format(
+        *decomposition(args.n_procs))
+    txt += "    delta           0.001;\n    order           xyz;\n}\n"
+    return txt + footer
+
+
+def dynamic_stall(args):
+    return ("        dynamicStall\n        {{\n"
+            "            active          {};\n"
+            "            dynamicStallModel LeishmanBeddoes;\n"
+            "        }}\n\n").format("on" if args.dynamic_stall else "off")
+
+
+def instance(name, origin):
+    """Return the coefficients in which the turbines differ."""
+    txt = "        selectionMode       cellSet;\n"
+    txt += "        cellSet             {};\n".format(name)
+    txt += "        origin              ({:g} {:g} {:g});\n".format(*origin)
+    return txt
+
+
+def turbine(name, turbine_type, coeffs):
+    txt = "{}\n{{\n".format(name)
+    txt += "    type            {};\n".format(turbine_type)
+    txt += "    active          on;\n\n"
+    txt += "    {}Coeffs\n    {{\n".format(turbine_type)
+    txt += "        fieldNames          (U);\n"
+    txt += coeffs
+    txt += "    }\n}\n\n"
+    return txt
+
+
+def axial_turbine(args, name, origin):
+    return turbine(name, "axialFlowTurbineALSource",
+                   instance(name, origin) + axial_coeffs(args))
+
+
+def axial_coeffs(args):
+    u = args.velocity
+    txt = "        axis                (-1 0 0);\n"
+    txt += "        verticalDirection   (0 0 1);\n"
+    txt += "        freeStreamVelocity  ({:g} 0 0);\n".format(u)
+    txt += "        tipSpeedRatio       6.0;\n"
+    txt += "        rotorRadius         {:g};\n\n".format(
+        0.5*diameters["axial"])
+    txt += dynamic_stall(args)
+    txt += "        endEffects\n        {\n"
+    txt += "            active          on;\n"
+    txt += "            endEffectsModel Glauert;\n"
+    txt += "        }\n\n"
+    txt += "        blades\n        {\n            blade1\n            {\n"
+    txt += "                writePerf   {};\n".format(
+        "true" if args.write_perf else "false")
+    txt += "                nElements   {};\n".format(args.blade_elements)
+    txt += "                elementProfiles (S826);\n"
+    txt += "                elementData\n                (\n"
+    for row in axial_blade_data:
+        txt += "                    ({} {} {} {} {} {})\n".format(*row)
+    txt += "                );\n            }\n"
+    txt += "            blade2\n            {\n                $blade1;\n"
+    txt += "                azimuthalOffset 120.0;\n            }\n"
+    txt += "            blade3\n            {\n                $blade2;\n"
+    txt += "                azimuthalOffset 240.0;\n            }\n"
+    txt += "        }\n\n"
+    txt += "        hub\n        {\n"
+    txt += "            nElements   1;\n"
+    txt += "            elementProfiles (cylinder);\n"
+    txt += "            elementData\n            (\n"
+    txt += "                (0 0.09 0.09)\n                (0 -0.09 0.09)\n"
+    txt += "            );\n        }\n\n"
+    txt += profile_data(["S826"])
+    return txt
+
+
+def cross_turbine(args, name, origin):
+    return turbine(name, "crossFlowTurbineALSource",
+                   instance(name, origin) + cross_coeffs(args))
+
+
+def cross_coeffs(args):
+    u = args.velocity
+    txt = "        axis                (0 0 1);\n"
+    txt += "        rotorRadius         {:g};\n".format(0.5*diameters["cross"])
+    txt += "        freeStreamVelocity  ({:g} 0 0);\n".format(u)
+    txt += "        tipSpeedRatio       1.9;\n\n"
+    txt += dynamic_stall(args)
+    txt += "        blades\n        {\n            blade1\n            {\n"
+    txt += "                writePerf   {};\n".format(
+        "true" if args.write_perf else "false")
+    txt += "                nElements   {};\n".format(args.blade_elements)
+    txt += "                endEffects  on;\n"
+    txt += "                elementProfiles (NACA0021);\n"
+    txt += "                elementData\n                (\n"
+    txt += "                    (-0.5 0.5 0.0 0.14 0.5 0.0)\n"
+    txt += "                    ( 0.5 0.5 0.0 0.14 0.5 0.0)\n"
+    txt += "                );\n            }\n"
+    txt += "            blade2\n            {\n                $blade1;\n"
+    txt += "                azimuthalOffset 120.0;\n            }\n"
+    txt += "            blade3\n            {\n                $blade2;\n"
+    txt += "                azimuthalOffset 240.0;\n            }\n"
+    txt += "        }\n\n"
+    txt += "        shaft\n        {\n"
+    txt += "            nElements   {};\n".format(max(args.blade_elements//2,
+                                                     1))
+    txt += "            elementProfiles (cylinder);\n"
+    txt += "            elementData\n            (\n"
+    txt += "                (-0.66 0.09)\n                ( 0.66 0.09)\n"
+    txt += "            );\n        }\n\n"
+    txt += profile_data(["NACA0021"])
+    return txt
+
+
+def profile_data(foils):
+    files = {"S826": "S826_1e5_Ostavan", "NACA0021": "NACA0021_1.6e5"}
+    txt = "        profileData\n        {\n"
+    for foil in foils:
+        path = os.path.normpath(os.path.join(foil_data_dir, files[foil]))
+        txt += "            {}\n            {{\n".format(foil)
+        txt += "                data (#include \"{}\");\n".format(path)
+        txt += "            }\n"
+    txt += "            cylinder\n            {\n"
+    txt += "                data ((-180 0 1.1)(180 0 1.1));\n"
+    txt += "            }\n        }\n"
+    return txt
+
+
+def indent(txt, n):
+    return "".join((" "*n + line).rstrip() + "\n"
+                   for line in txt.rstrip("\n").split("\n"))
+
+
+def farm(args):
+    """Return an `actuatorFarmSource` with one template per turbine type,
+    from which the turbines differ only by their cell set and origin.
+    """
+    types = turbine_types(args)
+    sources = {"axial": "axialFlowTurbineALSource",
+               "cross": "crossFlowTurbineALSource"}
+    coeffs = {"axial": axial_coeffs, "cross": cross_coeffs}
+    templates = ""
+    for t in sorted(set(types)):
+        templates += turbine(t, sources[t], coeffs[t](args))
+    turbines = ""
+    for n, (t, o) in enumerate(zip(types, turbine_origins(args))):
+        name = "turbine{}".format(n + 1)
+        turbines += "{}\n{{\n".format(name)
+        turbines += "    template        {};\n\n".format(t)
+        turbines += "    {}Coeffs\n    {{\n".format(sources[t])
+        turbines += instance(name, o)
+        turbines += "    }\n}\n\n"
+    txt = "farm\n{\n"
+    txt += "    type            actuatorFarmSource;\n"
+    txt += "    active          on;\n\n"
+    txt += "    actuatorFarmSourceCoeffs\n    {\n"
+    txt += "        fieldNames      (U);\n\n"
+    txt += "        templates\n        {\n"
+    txt += indent(templates, 12)
+    txt += "        }\n\n"
+    txt += "        turbines\n        {\n"
+    txt += indent(turbines, 12)
+    txt += "        }\n    }\n}\n"
+    return txt
+
+
+def fv_options(args):
+    txt = header.format("fvOptions") + "\n"
+    if args.farm:
+        txt += farm(args)
+    else:
+        for n, (t, o) in enumerate(zip(turbine_types(args),
+                                       turbine_origins(args))):
+            name = "turbine{}".format(n + 1)
+            if t == "axial":
+                txt += axial_turbine(args, name, o)
+            else:
+                txt += cross_turbine(args, name, o)
+    return txt.rstrip("\n") + "\n" + footer
+
+
+def control_dict(args):
+    txt = header.format("controlDict")
+    txt += "application     pimpleFoam;\n\n"
+    txt += "startFrom       startTime;\n\n"
+    txt += "startTime       0;\n\n"
+    txt += "stopAt          endTime;\n\n"
+    txt += "endTime         {:g};\n\n".format(args.steps*args.delta_t)
+    txt += "deltaT          {:g};\n\n".format(args.delta_t)
+    txt += "writeControl    timeStep;\n\n"
+    txt += "writeInterval   {};\n\n".format(args.steps)
+    txt += "writeFormat     binary;\n\n"
+    txt += "writePrecision  12;\n\n"
+    txt += "writeCompression compressed;\n\n"
+    txt += "timeFormat      general;\n\n"
+    txt += "timePrecision   6;\n\n"
+    txt += "runTimeModifiable false;\n\n"
+    txt += "libs\n(\n    \"libturbinesFoam.so\"\n);\n\n"
+    txt += "OptimisationSwitches\n{\n"
+    txt += "    actuatorProfiling {};\n".format(args.steps)
+    txt += "}\n"
+    return txt + footer
+
+
+def write_case(args, case_dir="."):
+    """Write the generated dictionaries to `case_dir`."""
+    system_dir = os.path.join(case_dir, "system")
+    if not os.path.isdir(system_dir):
+        os.makedirs(system_dir)
+    dicts = {"blockMeshDict": block_mesh_dict,
+             "topoSetDict": topo_set_dict,
+             "decomposeParDict": decompose_par_dict,
+             "fvOptions": fv_options,
+             "controlDict": control_dict}
+    for name, func in dicts.items():
+        with open(os.path.join(system_dir, name), "w") as f:
+            f.write(func(args))
+
+
+def summary(args):
+    """Return a one-line description of the generated case."""
+    types = turbine_types(args)
+    nx, ny, nz = n_cells(args)
+    return ("{} turbines ({} axial, {} cross-flow), {} cells, {} blade "
+            "elements, {} processors").format(
+                len(types), types.count("axial"), types.count("cross"),
+                nx*ny*nz, args.blade_elements, args.n_procs)
+
+
+def add_arguments(parser):
+    """Add the case generation arguments to `parser`."""
+    parser.add_argument("--rows", type=int, default=2,
+                        help="Number of turbine rows in the streamwise "
+                        "direction")
+    parser.add_argument("--cols", type=int, default=2,
+                        help="Number of turbine columns in the lateral "
+                        "direction")
+    parser.add_argument("--type", choices=["axial", "cross", "mixed"],
+                        default="axial", help="Turbine type, where mixed "
+                        "alternates axial and cross-flow turbines")
+    parser.add_argument("--spacing-x", type=float, default=5.0,
+                        help="Streamwise spacing in rotor diameters")
+    parser.add_argument("--spacing-y", type=float, default=3.0,
+                        help="Lateral spacing in rotor diameters")
+    parser.add_argument("--upstream", type=float, default=3.0,
+                        help="Domain length upstream of the first row in "
+                        "rotor diameters")
+    parser.add_argument("--downstream", type=float, default=6.0,
+                        help="Domain length downstream of the last row in "
+                        "rotor diameters")
+    parser.add_argument("--margin", type=float, default=1.5,
+                        help="Lateral and vertical domain margin in rotor "
+                        "diameters")
+    parser.add_argument("--cells-per-diameter", type=float, default=10,
+                        help="Number of cells per rotor diameter")
+    parser.add_argument("--blade-elements", type=int, default=16,
+                        help="Number of elements per blade")
+    parser.add_argument("--dynamic-stall", action="store_true",
+                        help="Activate the Leishman-Beddoes dynamic stall "
+                        "model")
+    parser.add_argument("--write-perf", action="store_true",
+                        help="Write blade performance")
+    parser.add_argument("--farm", action="store_true",
+                        help="Evaluate the turbines together in an "
+                        "actuatorFarmSource, defined from one template per "
+                        "turbine type")
+    parser.add_argument("--velocity", type=float, default=1.0,
+                        help="Free stream velocity in m/s")
+    parser.add_argument("--n-procs", type=int, default=1,
+                        help="Number of processors to decompose for")
+    parser.add_argument("--method", choices=["hierarchical", "scotch"],
+                        default="hierarchical",
+                        help="Decomposition method")
+    parser.add_argument("--steps", type=int, default=20,
+                        help="Number of time steps")
+    parser.add_argument("--delta-t", type=float, default=0.005,
+                        help="Time step in seconds")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Generate a wind farm "
+                                     "benchmark case.")
+    add_arguments(parser)
+    parser.add_argument("--case", default=".", help="Case directory")
+    args = parser.parse_args()
+    write_case(args, args.case)
+    print("Generated " + summary(args))
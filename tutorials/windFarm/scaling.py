@@ -0,0 +1,171 @@
+#!/usr/bin/env python
+"""
+This script runs the wind farm benchmark over a range of processor counts and
+tabulates the actuator time per step, scaling efficiency and memory.
+
+In strong scaling the farm is fixed, and in weak scaling the number of turbine
+columns, and hence turbines and cells, grows with the number of processors.
+The `frozen` solver advances only the fvOptions in a frozen velocity field
+with `actuatorFrozenFlow`, while the `live` solver runs `pimpleFoam` with
+actuator profiling active.
+"""
+
+from __future__ import division, print_function, absolute_import
+import argparse
+import copy
+import glob
+import os
+import re
+import shutil
+import subprocess
+import generate
+
+
+def run(case_dir, app, n_procs, *app_args):
+    """Run an application in `case_dir`, writing its output to `log.<app>`.
+    """
+    cmd = [app] + list(app_args)
+    if n_procs > 1 and app not in ["blockMesh", "topoSet", "decomposePar"]:
+        cmd = ["mpirun", "-np", str(n_procs)] + cmd + ["-parallel"]
+    with open(os.path.join(case_dir, "log." + app), "w") as log:
+        status = subprocess.call(cmd, cwd=case_dir, stdout=log,
+                                 stderr=subprocess.STDOUT)
+    if status != 0:
+        raise RuntimeError("{} failed in {}".format(" ".join(cmd), case_dir))
+
+
+def read_log(case_dir, app):
+    with open(os.path.join(case_dir, "log." + app)) as f:
+        return f.read()
+
+
+def memory_mb(log):
+    """Return the sum of the maximum memory per processor of all turbines,
+    from the memory reports in `log`.
+    """
+    totals = re.findall(r"Memory of .*?\n(?:    .*\n)*?    total: (\S+), "
+                        r"(\S+)", log)
+    return sum(float(maximum) for minimum, maximum in totals)
+
+
+def frozen_time_per_step(case_dir):
+    """Return the maximum over processors of the mean fvOptions time per
+    step of `actuatorFrozenFlow`.
+    """
+    log = read_log(case_dir, "actuatorFrozenFlow")
+    return float(re.search(r"max of processor means: (\S+)", log).group(1))
+
+
+def live_time_per_step(case_dir, n_steps):
+    """Return the maximum over processors of the total time of the actuator
+    phases per step, from the last row of the actuator profiling output.
+    """
+    fnames = glob.glob(os.path.join(case_dir, "postProcessing",
+                                    "actuatorProfiling", "*",
+                                    "actuatorProfiling.csv"))
+    if not fnames:
+        raise RuntimeError("No actuator profiling output in {}; check that "
+                           "the actuatorProfiling optimisation switch is set "
+                           "in system/controlDict".format(case_dir))
+    with open(sorted(fnames)[-1]) as f:
+        lines = f.read().split()
+    names = lines[0].split(",")
+    values = [float(v) for v in lines[-1].split(",")]
+    return values[names.index("total_s_max")]/n_steps
+
+
+def run_case(args, n_procs):
+    """Generate and run the case for `n_procs` processors, returning a
+    dictionary of its results.
+    """
+    case_args = copy.copy(args)
+    case_args.n_procs = n_procs
+    if args.mode == "weak":
+        case_args.cols = args.cols*n_procs
+    case_dir = os.path.join(args.output_dir,
+                            "{}-{}-np{}".format(args.mode, args.solver,
+                                                n_procs))
+    if os.path.isdir(case_dir):
+        shutil.rmtree(case_dir)
+    for d in ["constant", "system"]:
+        shutil.copytree(d, os.path.join(case_dir, d))
+    shutil.copytree("0.org", os.path.join(case_dir, "0"))
+    generate.write_case(case_args, case_dir)
+    print("Running " + generate.summary(case_args))
+
+    run(case_dir, "blockMesh", 1)
+    run(case_dir, "topoSet", 1)
+    if n_procs > 1:
+        run(case_dir, "decomposePar", 1, "-force")
+    if args.solver == "frozen":
+        app = "actuatorFrozenFlow"
+        run(case_dir, app, n_procs, "-steps", str(args.steps))
+        time_per_step = frozen_time_per_step(case_dir)
+    else:
+        app = "pimpleFoam"
+        run(case_dir, app, n_procs)
+        time_per_step = live_time_per_step(case_dir, args.steps)
+
+    types = generate.turbine_types(case_args)
+    nx, ny, nz = generate.n_cells(case_args)
+    return {"n_procs": n_procs,
+            "n_turbines": len(types),
+            "n_cells": nx*ny*nz,
+            "actuator_time_per_step": time_per_step,
+            "memory_mb": memory_mb(read_log(case_dir, app))}
+
+
+def add_efficiency(results, mode):
+    """Add the scaling efficiency relative to the smallest processor count.
+    """
+    ref = results[0]
+    for r in results:
+        if mode == "strong":
+            r["efficiency"] = (ref["actuator_time_per_step"]*ref["n_procs"]
+                               / (r["actuator_time_per_step"]*r["n_procs"]))
+        else:
+            r["efficiency"] = (ref["actuator_time_per_step"]
+                               / r["actuator_time_per_step"])
+
+
+def write_table(results, fname):
+    """Print the results as a table and write them to a CSV file."""
+    cols = ["n_procs", "n_turbines", "n_cells", "actuator_time_per_step",
+            "efficiency", "memory_mb"]
+    with open(fname, "w") as f:
+        f.write(",".join(cols) + "\n")
+        for r in results:
+            f.write(",".join(str(r[c]) for c in cols) + "\n")
+    print("\n| " + " | ".join(cols) + " |")
+    print("|" + "---|"*len(cols))
+    for r in results:
+        print("| {n_procs} | {n_turbines} | {n_cells} | "
+              "{actuator_time_per_step:.4g} | {efficiency:.3f} | "
+              "{memory_mb:.4g} |".format(**r))
+    print("\nResults written to " + fname)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Run the wind farm "
+                                     "benchmark over a range of processor "
+                                     "counts.")
+    generate.add_arguments(parser)
+    parser.add_argument("--procs", type=int, nargs="+", default=[1, 2, 4],
+                        help="Processor counts to run")
+    parser.add_argument("--mode", choices=["strong", "weak"],
+                        default="strong", help="Scaling mode")
+    parser.add_argument("--solver", choices=["frozen", "live"],
+                        default="frozen", help="Advance the fvOptions in a "
+                        "frozen flow or run pimpleFoam")
+    parser.add_argument("--output-dir", default="scaling",
+                        help="Directory for the cases and results")
+    args = parser.parse_args()
+
+    os.chdir(os.path.dirname(os.path.abspath(__file__)))
+    if not os.path.isdir(args.output_dir):
+        os.makedirs(args.output_dir)
+    results = [run_case(args, n) for n in sorted(args.procs)]
+    add_efficiency(results, args.mode)
+    write_table(results, os.path.join(args.output_dir,
+                                      "{}-{}.csv".format(args.mode,
+                                                         args.solver)))